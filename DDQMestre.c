@@ -17,35 +17,200 @@
 
     O objetivo é aplicar os conceitos de Hashing e integração de 
     múltiplas estruturas de dados (Árvore + Tabela Hash).
+
+    Para economizar memória, salas, pistas e nós da hash ficam em vetores
+    (pools) e se ligam por índices de 32 bits em vez de ponteiros. Os nomes
+    ficam todos em um único vetor de caracteres, cada um guardado uma vez só.
 -------------------------------------------------------------
 */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+
+#define NULO 0   // O índice 0 de cada vetor é reservado e faz o papel de NULL
 
 // ======= ESTRUTURA DE SALAS (mantida do nível Novato) =======
 typedef struct Sala {
-    char nome[50];
-    struct Sala *esquerda;
-    struct Sala *direita;
+    uint32_t nome;        // Posição do nome no vetor de nomes
+    uint32_t esquerda;    // Índice da sala à esquerda (NULO se não houver)
+    uint32_t direita;     // Índice da sala à direita
 } Sala;
 
 // ======= ESTRUTURA DE PISTAS (mantida do nível Aventureiro) =======
 typedef struct Pista {
-    char nome[50];
-    struct Pista *esquerda;
-    struct Pista *direita;
+    uint32_t nome;
+    uint32_t esquerda;
+    uint32_t direita;
 } Pista;
 
 // ======= ESTRUTURA DE TABELA HASH (nova neste nível) =======
 typedef struct NodoHash {
-    char pista[50];           // Nome da pista
-    char suspeito[50];        // Suspeito relacionado à pista
-    struct NodoHash* prox;    // Ponteiro para encadeamento (em caso de colisão)
+    uint32_t pista;       // Índice da pista na BST (o nome não é copiado de novo)
+    uint32_t suspeito;    // Índice do suspeito na lista de suspeitos
+    uint32_t prox;        // Próximo nó da lista encadeada (em caso de colisão)
 } NodoHash;
 
 #define TAM_TABELA 10   // Tamanho fixo da tabela hash (poderia ser maior em projetos reais)
+#define MAX_SUSPEITOS 20
+
+// ======= VETOR DE NOMES: todos os textos guardados em sequência, separados por '\0' =======
+typedef struct VetorNomes {
+    char* dados;
+    uint32_t tamanho, capacidade;
+} VetorNomes;
+
+// ======= MANSÃO: mapa compartilhado, não muda durante o jogo =======
+typedef struct Mansao {
+    VetorNomes nomes;                   // Nomes das salas
+    Sala* salas;
+    uint32_t numSalas, capSalas;
+} Mansao;
+
+// ======= INVESTIGAÇÃO: pistas e suspeitos de um jogador =======
+typedef struct Investigacao {
+    VetorNomes nomes;                   // Nomes das pistas e dos suspeitos
+
+    Pista* pistas;
+    uint32_t numPistas, capPistas;
+    uint32_t raizPistas;                // Raiz da BST de pistas
+
+    NodoHash* nodos;
+    uint32_t numNodos, capNodos;
+
+    uint32_t tabela[TAM_TABELA];        // Início de cada lista da hash
+    uint32_t suspeitos[MAX_SUSPEITOS];  // Posição do nome de cada suspeito
+    int numSuspeitos;
+} Investigacao;
+
+/*
+Função: garantirEspaco
+Descrição:
+Dobra a capacidade de um vetor quando ele está cheio e devolve o vetor
+(possivelmente realocado). Depois de chamá-la, índices continuam válidos,
+mas ponteiros antigos para dentro do vetor não.
+*/
+void* garantirEspaco(void* vetor, uint32_t quantidade, uint32_t* capacidade, size_t tamElemento) {
+    if (quantidade < *capacidade) {
+        return vetor;
+    }
+    uint32_t novaCapacidade = (*capacidade == 0) ? 8 : *capacidade * 2;
+    void* novo = realloc(vetor, (size_t) novaCapacidade * tamElemento);
+    if (novo == NULL) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+    *capacidade = novaCapacidade;
+    return novo;
+}
+
+/*
+Função: iniciarNomes
+Descrição:
+Cria o vetor de nomes com a posição 0 ocupada por um texto vazio.
+*/
+void iniciarNomes(VetorNomes* nomes) {
+    nomes->capacidade = 0;
+    nomes->dados = garantirEspaco(NULL, 0, &nomes->capacidade, sizeof(char));
+    nomes->dados[0] = '\0';
+    nomes->tamanho = 1;
+}
+
+/*
+Função: guardarNome
+Descrição:
+Copia um nome para o fim do vetor de nomes e devolve sua posição.
+*/
+uint32_t guardarNome(VetorNomes* nomes, char* nome) {
+    uint32_t tamanho = (uint32_t) strlen(nome) + 1;
+    while (nomes->tamanho + tamanho > nomes->capacidade) {
+        nomes->dados = garantirEspaco(nomes->dados, nomes->capacidade, &nomes->capacidade, sizeof(char));
+    }
+    uint32_t posicao = nomes->tamanho;
+    memcpy(nomes->dados + posicao, nome, tamanho);
+    nomes->tamanho += tamanho;
+    return posicao;
+}
+
+/*
+Função: nomeDe
+Descrição:
+Devolve o texto guardado em uma posição do vetor de nomes.
+*/
+char* nomeDe(const VetorNomes* nomes, uint32_t posicao) {
+    return nomes->dados + posicao;
+}
+
+/*
+Função: iniciarMansao
+Descrição:
+Deixa a mansão vazia e reserva a posição 0 do vetor de salas para representar NULO.
+*/
+void iniciarMansao(Mansao* mansao) {
+    memset(mansao, 0, sizeof(Mansao));
+    iniciarNomes(&mansao->nomes);
+    mansao->salas = garantirEspaco(NULL, 0, &mansao->capSalas, sizeof(Sala));
+    mansao->numSalas = 1;
+}
+
+/*
+Função: liberarMansao
+Descrição:
+Libera os vetores da mansão (um free por vetor).
+*/
+void liberarMansao(Mansao* mansao) {
+    free(mansao->nomes.dados);
+    free(mansao->salas);
+    memset(mansao, 0, sizeof(Mansao));
+}
+
+/*
+Função: iniciarInvestigacao
+Descrição:
+Deixa a investigação vazia e reserva a posição 0 de cada vetor para representar NULO.
+*/
+void iniciarInvestigacao(Investigacao* investigacao) {
+    memset(investigacao, 0, sizeof(Investigacao));
+    iniciarNomes(&investigacao->nomes);
+    investigacao->pistas = garantirEspaco(NULL, 0, &investigacao->capPistas, sizeof(Pista));
+    investigacao->numPistas = 1;
+    investigacao->nodos = garantirEspaco(NULL, 0, &investigacao->capNodos, sizeof(NodoHash));
+    investigacao->numNodos = 1;
+}
+
+/*
+Função: liberarInvestigacao
+Descrição:
+Libera os vetores da investigação (não há nós soltos para percorrer).
+*/
+void liberarInvestigacao(Investigacao* investigacao) {
+    free(investigacao->nomes.dados);
+    free(investigacao->pistas);
+    free(investigacao->nodos);
+    memset(investigacao, 0, sizeof(Investigacao));
+}
+
+/*
+Função: internarSuspeito
+Descrição:
+Devolve o índice do suspeito, cadastrando-o se ainda não existir.
+Assim cada nome de suspeito é guardado uma única vez, não importa
+quantas pistas apontem para ele.
+*/
+uint32_t internarSuspeito(Investigacao* investigacao, char* nome) {
+    for (int i = 0; i < investigacao->numSuspeitos; i++) {
+        if (strcmp(nomeDe(&investigacao->nomes, investigacao->suspeitos[i]), nome) == 0) {
+            return (uint32_t) i;
+        }
+    }
+    if (investigacao->numSuspeitos == MAX_SUSPEITOS) {
+        printf("Limite de suspeitos atingido!\n");
+        exit(1);
+    }
+    investigacao->suspeitos[investigacao->numSuspeitos] = guardarNome(&investigacao->nomes, nome);
+    return (uint32_t) investigacao->numSuspeitos++;
+}
 
 /*
 Função: funcaoHash
@@ -66,25 +231,28 @@ Descrição:
 Insere um par pista → suspeito na tabela hash. 
 Usa encadeamento caso o índice já esteja ocupado.
 */
-void inserirNaHash(NodoHash* tabela[], char* pista, char* suspeito) {
-    int indice = funcaoHash(pista);
+void inserirNaHash(Investigacao* investigacao, uint32_t pista, char* suspeito) {
+    int indice = funcaoHash(nomeDe(&investigacao->nomes, investigacao->pistas[pista].nome));
+    uint32_t idSuspeito = internarSuspeito(investigacao, suspeito);
 
-    NodoHash* novo = (NodoHash*) malloc(sizeof(NodoHash));
-    strcpy(novo->pista, pista);
-    strcpy(novo->suspeito, suspeito);
-    novo->prox = NULL;
+    investigacao->nodos = garantirEspaco(investigacao->nodos, investigacao->numNodos,
+                                         &investigacao->capNodos, sizeof(NodoHash));
+    uint32_t novo = investigacao->numNodos++;
+    investigacao->nodos[novo].pista = pista;
+    investigacao->nodos[novo].suspeito = idSuspeito;
+    investigacao->nodos[novo].prox = NULO;
 
     // Caso o índice esteja vazio
-    if (tabela[indice] == NULL) {
-        tabela[indice] = novo;
+    if (investigacao->tabela[indice] == NULO) {
+        investigacao->tabela[indice] = novo;
     } 
     // Caso já exista algo no índice (colisão)
     else {
-        NodoHash* atual = tabela[indice];
-        while (atual->prox != NULL) {
-            atual = atual->prox;
+        uint32_t atual = investigacao->tabela[indice];
+        while (investigacao->nodos[atual].prox != NULO) {
+            atual = investigacao->nodos[atual].prox;
         }
-        atual->prox = novo;
+        investigacao->nodos[atual].prox = novo;
     }
 }
 
@@ -93,13 +261,16 @@ Função: exibirHash
 Descrição:
 Percorre a tabela hash e mostra todas as associações pista → suspeito.
 */
-void exibirHash(NodoHash* tabela[]) {
-    printf("\n=== Relações de Pistas e Suspeitos ===\n");
+void exibirHash(FILE* saida, Investigacao* investigacao) {
+    fprintf(saida, "\n=== Relações de Pistas e Suspeitos ===\n");
     for (int i = 0; i < TAM_TABELA; i++) {
-        NodoHash* atual = tabela[i];
-        while (atual != NULL) {
-            printf("Pista: %-20s | Suspeito: %s\n", atual->pista, atual->suspeito);
-            atual = atual->prox;
+        uint32_t atual = investigacao->tabela[i];
+        while (atual != NULO) {
+            NodoHash* nodo = &investigacao->nodos[atual];
+            fprintf(saida, "Pista: %-20s | Suspeito: %s\n",
+                    nomeDe(&investigacao->nomes, investigacao->pistas[nodo->pista].nome),
+                    nomeDe(&investigacao->nomes, investigacao->suspeitos[nodo->suspeito]));
+            atual = nodo->prox;
         }
     }
 }
@@ -110,80 +281,68 @@ Descrição:
 Percorre toda a tabela hash e conta quantas vezes cada suspeito aparece.
 Em seguida, mostra o suspeito mais citado.
 */
-void contarSuspeitos(NodoHash* tabela[]) {
-    char nomes[20][50];   // Vetor de nomes de suspeitos
-    int contagens[20];    // Quantidade de vezes que aparecem
+void contarSuspeitos(FILE* saida, Investigacao* investigacao) {
+    int contagens[MAX_SUSPEITOS] = {0};  // Quantidade de vezes que cada suspeito aparece
     int total = 0;
 
-    // Inicializa contadores
-    for (int i = 0; i < 20; i++) {
-        contagens[i] = 0;
-        strcpy(nomes[i], "");
-    }
-
-    // Percorre toda a tabela hash
+    // Percorre toda a tabela hash (o suspeito já vem como índice, sem strcmp)
     for (int i = 0; i < TAM_TABELA; i++) {
-        NodoHash* atual = tabela[i];
-        while (atual != NULL) {
-            int encontrado = 0;
-            // Verifica se o suspeito já está na lista
-            for (int j = 0; j < total; j++) {
-                if (strcmp(nomes[j], atual->suspeito) == 0) {
-                    contagens[j]++;
-                    encontrado = 1;
-                    break;
-                }
-            }
-            // Se for um suspeito novo
-            if (!encontrado) {
-                strcpy(nomes[total], atual->suspeito);
-                contagens[total] = 1;
-                total++;
-            }
-            atual = atual->prox;
+        uint32_t atual = investigacao->tabela[i];
+        while (atual != NULO) {
+            contagens[investigacao->nodos[atual].suspeito]++;
+            total++;
+            atual = investigacao->nodos[atual].prox;
         }
     }
 
     // Descobre o mais citado
     int max = 0;
-    char suspeitoMaisCitado[50] = "";
-    for (int i = 0; i < total; i++) {
+    int maisCitado = 0;
+    for (int i = 0; i < investigacao->numSuspeitos; i++) {
         if (contagens[i] > max) {
             max = contagens[i];
-            strcpy(suspeitoMaisCitado, nomes[i]);
+            maisCitado = i;
         }
     }
 
     if (total > 0) {
-        printf("\n🔎 Suspeito mais citado nas pistas: %s (%d menções)\n", suspeitoMaisCitado, max);
+        fprintf(saida, "\n🔎 Suspeito mais citado nas pistas: %s (%d menções)\n",
+                nomeDe(&investigacao->nomes, investigacao->suspeitos[maisCitado]), max);
     } else {
-        printf("\nNenhum suspeito foi encontrado nas pistas.\n");
+        fprintf(saida, "\nNenhum suspeito foi encontrado nas pistas.\n");
     }
 }
 
 /*
 Função: criarSala
 Descrição:
-Cria uma nova sala dinamicamente (igual aos níveis anteriores).
+Cria uma nova sala no vetor de salas da mansão e devolve seu índice.
 */
-Sala* criarSala(char nome[]) {
-    Sala* nova = (Sala*) malloc(sizeof(Sala));
-    strcpy(nova->nome, nome);
-    nova->esquerda = NULL;
-    nova->direita = NULL;
+uint32_t criarSala(Mansao* mansao, char nome[]) {
+    uint32_t posNome = guardarNome(&mansao->nomes, nome);
+
+    mansao->salas = garantirEspaco(mansao->salas, mansao->numSalas, &mansao->capSalas, sizeof(Sala));
+    uint32_t nova = mansao->numSalas++;
+    mansao->salas[nova].nome = posNome;
+    mansao->salas[nova].esquerda = NULO;
+    mansao->salas[nova].direita = NULO;
     return nova;
 }
 
 /*
 Função: criarPista
 Descrição:
-Cria uma nova pista (nó da árvore BST).
+Cria uma nova pista (nó da árvore BST) e devolve seu índice.
 */
-Pista* criarPista(char nome[]) {
-    Pista* nova = (Pista*) malloc(sizeof(Pista));
-    strcpy(nova->nome, nome);
-    nova->esquerda = NULL;
-    nova->direita = NULL;
+uint32_t criarPista(Investigacao* investigacao, char nome[]) {
+    uint32_t posNome = guardarNome(&investigacao->nomes, nome);
+
+    investigacao->pistas = garantirEspaco(investigacao->pistas, investigacao->numPistas,
+                                          &investigacao->capPistas, sizeof(Pista));
+    uint32_t nova = investigacao->numPistas++;
+    investigacao->pistas[nova].nome = posNome;
+    investigacao->pistas[nova].esquerda = NULO;
+    investigacao->pistas[nova].direita = NULO;
     return nova;
 }
 
@@ -191,64 +350,393 @@ Pista* criarPista(char nome[]) {
 Função: inserirPista
 Descrição:
 Insere uma pista na árvore BST de forma ordenada.
+O filho é calculado antes de ser gravado porque a inserção pode realocar o vetor.
 */
-Pista* inserirPista(Pista* raiz, char nome[]) {
-    if (raiz == NULL) {
-        return criarPista(nome);
+uint32_t inserirPista(Investigacao* investigacao, uint32_t raiz, char nome[]) {
+    if (raiz == NULO) {
+        return criarPista(investigacao, nome);
+    }
+    int cmp = strcmp(nome, nomeDe(&investigacao->nomes, investigacao->pistas[raiz].nome));
+    if (cmp < 0) {
+        uint32_t filho = inserirPista(investigacao, investigacao->pistas[raiz].esquerda, nome);
+        investigacao->pistas[raiz].esquerda = filho;
+    } else if (cmp > 0) {
+        uint32_t filho = inserirPista(investigacao, investigacao->pistas[raiz].direita, nome);
+        investigacao->pistas[raiz].direita = filho;
     }
-    int cmp = strcmp(nome, raiz->nome);
-    if (cmp < 0)
-        raiz->esquerda = inserirPista(raiz->esquerda, nome);
-    else if (cmp > 0)
-        raiz->direita = inserirPista(raiz->direita, nome);
     return raiz;
 }
 
 /*
-Função: explorarSalas
+Função: buscarPista
 Descrição:
-Permite explorar a mansão e associar pistas a suspeitos automaticamente.
-Cada pista encontrada será armazenada na BST e também registrada na hash.
+Procura uma pista pelo nome dentro da BST.
+Retorna o índice da pista, ou NULO se não encontrada.
 */
-void explorarSalas(Sala* atual, Pista** arvorePistas, NodoHash* tabela[]) {
-    char opcao;
+uint32_t buscarPista(Investigacao* investigacao, uint32_t raiz, char nome[]) {
+    if (raiz == NULO)
+        return NULO;
 
-    while (1) {
-        printf("\nVocê está em: %s\n", atual->nome);
-        printf("[e] Ir para a esquerda\n");
-        printf("[d] Ir para a direita\n");
-        printf("[p] Ver relações pista → suspeito\n");
-        printf("[s] Sair da exploração\n");
-        printf(">> ");
-        scanf(" %c", &opcao);
-
-        if (opcao == 's') {
-            printf("\nVocê decidiu parar a exploração. Até a próxima, detetive!\n");
+    int cmp = strcmp(nome, nomeDe(&investigacao->nomes, investigacao->pistas[raiz].nome));
+    if (cmp == 0)
+        return raiz;
+    else if (cmp < 0)
+        return buscarPista(investigacao, investigacao->pistas[raiz].esquerda, nome);
+    else
+        return buscarPista(investigacao, investigacao->pistas[raiz].direita, nome);
+}
+
+/*
+Função: tamanhoBloco
+Descrição:
+Estima quantos bytes um malloc(tamanho) ocupa de fato no heap. O alocador
+guarda um cabeçalho antes de cada bloco e arredonda o tamanho; aqui seguimos
+a regra do glibc (cabeçalho de um size_t, alinhamento de 2 size_t e bloco
+mínimo de 4 size_t).
+*/
+size_t tamanhoBloco(size_t tamanho) {
+    size_t alinhamento = 2 * sizeof(size_t);
+    size_t bloco = (tamanho + sizeof(size_t) + alinhamento - 1) / alinhamento * alinhamento;
+    return (bloco < 4 * sizeof(size_t)) ? 4 * sizeof(size_t) : bloco;
+}
+
+/*
+Função: mediaPorNo
+Descrição:
+Divide bytes entre nós, arredondando para cima (0 se não houver nós).
+*/
+size_t mediaPorNo(size_t bytes, size_t quantidade) {
+    return (quantidade == 0) ? 0 : (bytes + quantidade - 1) / quantidade;
+}
+
+/*
+Função: exibirRelatorioMemoria
+Descrição:
+Compara quantos bytes salas, pistas e associações ocupavam no formato antigo
+(um malloc por nó, nome embutido + ponteiros) com o formato atual
+(vetores com índices + vetor de nomes). Os dois lados contam o custo do
+alocador; no formato atual isso inclui a folga de capacidade dos vetores.
+*/
+void exibirRelatorioMemoria(FILE* saida, const Mansao* mansao, Investigacao* investigacao) {
+    // Formatos antigos, mantidos aqui apenas para medir o tamanho
+    struct SalaAntiga { char nome[50]; void* esquerda; void* direita; };
+    struct PistaAntiga { char nome[50]; void* esquerda; void* direita; };
+    struct NodoHashAntigo { char pista[50]; char suspeito[50]; void* prox; };
+
+    // A posição 0 de cada vetor é reservada, por isso o "- 1"
+    size_t qtdSalas = mansao->numSalas - 1;
+    size_t qtdPistas = investigacao->numPistas - 1;
+    size_t qtdAssociacoes = investigacao->numNodos - 1;
+
+    // Bytes de nomes de cada tipo de nó (o restante do vetor da investigação são suspeitos)
+    size_t nomesSalas = mansao->nomes.tamanho - 1;
+    size_t nomesPistas = 0;
+    for (uint32_t i = 1; i < investigacao->numPistas; i++) {
+        nomesPistas += strlen(nomeDe(&investigacao->nomes, investigacao->pistas[i].nome)) + 1;
+    }
+    size_t nomesSuspeitos = investigacao->nomes.tamanho - 1 - nomesPistas;
+
+    // Antes: um bloco de malloc por nó e uma tabela de ponteiros
+    size_t antesMapa = qtdSalas * tamanhoBloco(sizeof(struct SalaAntiga));
+    size_t antesJogador = qtdPistas * tamanhoBloco(sizeof(struct PistaAntiga))
+                        + qtdAssociacoes * tamanhoBloco(sizeof(struct NodoHashAntigo))
+                        + TAM_TABELA * sizeof(void*);
+
+    // Agora: um bloco por vetor (com a folga de capacidade), tabela e suspeitos por índice
+    size_t agoraMapa = tamanhoBloco((size_t) mansao->capSalas * sizeof(Sala))
+                     + tamanhoBloco(mansao->nomes.capacidade);
+    size_t agoraJogador = tamanhoBloco((size_t) investigacao->capPistas * sizeof(Pista))
+                        + tamanhoBloco((size_t) investigacao->capNodos * sizeof(NodoHash))
+                        + tamanhoBloco(investigacao->nomes.capacidade)
+                        + sizeof(investigacao->tabela)
+                        + sizeof(investigacao->suspeitos);
+
+    // "Associação" tem 2 caracteres acentuados (2 bytes cada), por isso é preenchida à mão
+    fprintf(saida, "\n=== Relatório de Memória ===\n");
+    fprintf(saida, "%-12s | %6s | %12s | %12s | %12s\n", "Estrutura", "Qtd", "Struct antes", "Bloco antes", "Agora (B/nó)");
+    fprintf(saida, "%-12s | %6zu | %12zu | %12zu | %12zu\n", "Sala", qtdSalas,
+            sizeof(struct SalaAntiga), tamanhoBloco(sizeof(struct SalaAntiga)),
+            sizeof(Sala) + mediaPorNo(nomesSalas, qtdSalas));
+    fprintf(saida, "%-12s | %6zu | %12zu | %12zu | %12zu\n", "Pista", qtdPistas,
+            sizeof(struct PistaAntiga), tamanhoBloco(sizeof(struct PistaAntiga)),
+            sizeof(Pista) + mediaPorNo(nomesPistas, qtdPistas));
+    fprintf(saida, "%s | %6zu | %12zu | %12zu | %12zu\n", "Associação  ", qtdAssociacoes,
+            sizeof(struct NodoHashAntigo), tamanhoBloco(sizeof(struct NodoHashAntigo)),
+            sizeof(NodoHash) + mediaPorNo(nomesSuspeitos, qtdAssociacoes));
+    fprintf(saida, "(Agora = nó de índices + parte média do vetor de nomes; %d suspeitos distintos)\n",
+            investigacao->numSuspeitos);
+    fprintf(saida, "Mapa (compartilhado): antes %zu bytes | agora %zu bytes alocados\n", antesMapa, agoraMapa);
+    fprintf(saida, "Por jogador:          antes %zu bytes | agora %zu bytes alocados\n", antesJogador, agoraJogador);
+    fprintf(saida, "Total antes: %zu bytes | Total agora: %zu bytes alocados\n",
+            antesMapa + antesJogador, agoraMapa + agoraJogador);
+}
+
+// ======= LEITURA DE COMANDOS EM LOTE (uma linha por leitura) =======
+#define TAM_FILA 64        // Comandos aceitos por linha; os que passarem disso são descartados
+#define TAM_LINHA 256      // Tamanho máximo de uma linha lida do terminal/pipe
+#define TAM_BUFFER_SAIDA 4096  // Buffer de saída: as mensagens são enviadas em lote
+
+// Fila circular de comandos já interpretados, aguardando o motor do jogo
+typedef struct FilaComandos {
+    char comandos[TAM_FILA];
+    int inicio;
+    int quantidade;
+} FilaComandos;
+
+// Estado de uma sessão de jogo: tudo que o motor precisa para processar um comando
+typedef struct Sessao {
+    const Mansao* mansao;         // Mapa compartilhado (só leitura)
+    Investigacao* investigacao;   // Pistas e suspeitos deste jogador
+    uint32_t atual;               // Índice da sala onde o jogador está
+    FILE* saida;              // Para onde vão as mensagens desta sessão
+    FilaComandos fila;        // Comandos pendentes desta sessão
+    int ativa;                // 0 quando o jogador sai ou chega a uma sala final
+} Sessao;
+
+/*
+Função: enfileirarComando
+Descrição:
+Adiciona um comando no fim da fila. Retorna 0 se a fila estiver cheia.
+*/
+int enfileirarComando(FilaComandos* fila, char comando) {
+    if (fila->quantidade == TAM_FILA) {
+        return 0;
+    }
+    fila->comandos[(fila->inicio + fila->quantidade) % TAM_FILA] = comando;
+    fila->quantidade++;
+    return 1;
+}
+
+/*
+Função: desenfileirarComando
+Descrição:
+Remove o comando do início da fila. Retorna 0 se a fila estiver vazia.
+*/
+int desenfileirarComando(FilaComandos* fila, char* comando) {
+    if (fila->quantidade == 0) {
+        return 0;
+    }
+    *comando = fila->comandos[fila->inicio];
+    fila->inicio = (fila->inicio + 1) % TAM_FILA;
+    fila->quantidade--;
+    return 1;
+}
+
+/*
+Função: lerComandos
+Descrição:
+Lê uma linha inteira da entrada e enfileira todos os comandos válidos dela,
+ignorando espaços (no máximo TAM_FILA por linha). Assim, "e d p" é
+interpretado de uma vez, sem um menu e uma leitura para cada tecla.
+A leitura em si ainda bloqueia (fgets); ela só é feita quando a fila está vazia.
+Retorna 0 quando a entrada termina (EOF).
+*/
+int lerComandos(FILE* entrada, FILE* saida, FilaComandos* fila) {
+    char linha[TAM_LINHA];
+
+    if (fgets(linha, sizeof(linha), entrada) == NULL) {
+        return 0;
+    }
+    for (int i = 0; linha[i] != '\0'; i++) {
+        char c = linha[i];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            continue;
+        }
+        if (!enfileirarComando(fila, c)) {
+            fprintf(saida, "\nMuitos comandos de uma vez! O restante da linha foi ignorado.\n");
+            // Se a linha não coube no buffer, descarta o resto dela até o '\n'
+            if (strchr(linha, '\n') == NULL) {
+                int resto;
+                do {
+                    resto = fgetc(entrada);
+                } while (resto != '\n' && resto != EOF);
+            }
             break;
         }
-        else if (opcao == 'p') {
-            exibirHash(tabela);
+    }
+    return 1;
+}
+
+/*
+Função: exibirMenu
+Descrição:
+Mostra a sala atual e as opções disponíveis para o jogador.
+*/
+void exibirMenu(Sessao* sessao) {
+    const Mansao* mansao = sessao->mansao;
+
+    fprintf(sessao->saida, "\nVocê está em: %s\n", nomeDe(&mansao->nomes, mansao->salas[sessao->atual].nome));
+    fprintf(sessao->saida, "[e] Ir para a esquerda\n");
+    fprintf(sessao->saida, "[d] Ir para a direita\n");
+    fprintf(sessao->saida, "[p] Ver relações pista → suspeito\n");
+    fprintf(sessao->saida, "[m] Ver relatório de memória\n");
+    fprintf(sessao->saida, "[s] Sair da exploração\n");
+    fprintf(sessao->saida, ">> ");
+}
+
+/*
+Função: registrarPistaDaSala
+Descrição:
+Verifica se a sala atual contém uma pista. Se sim, guarda a pista na BST
+e associa o suspeito correspondente na tabela hash.
+*/
+void registrarPistaDaSala(Sessao* sessao) {
+    const Mansao* mansao = sessao->mansao;
+    Investigacao* investigacao = sessao->investigacao;
+    uint32_t nomeSala = mansao->salas[sessao->atual].nome;  // Posição, não ponteiro: os vetores podem ser realocados
+    char* pista = NULL;
+    char* suspeito = NULL;
+
+    if (strcmp(nomeDe(&mansao->nomes, nomeSala), "Biblioteca Misteriosa") == 0) {
+        pista = "Diário Rasgado";
+        suspeito = "Sr. Blackwood";
+    } else if (strcmp(nomeDe(&mansao->nomes, nomeSala), "Jardim Abandonado") == 0) {
+        pista = "Chave Enferrujada";
+        suspeito = "Sra. Violet";
+    } else if (strcmp(nomeDe(&mansao->nomes, nomeSala), "Cozinha Antiga") == 0) {
+        pista = "Receita Queimada";
+        suspeito = "Sra. Violet";
+    } else if (strcmp(nomeDe(&mansao->nomes, nomeSala), "Porão Escuro") == 0) {
+        pista = "Fotografia Antiga";
+        suspeito = "Sr. Blackwood";
+    }
+
+    if (pista != NULL) {
+        fprintf(sessao->saida, "\nVocê encontrou uma pista: '%s'\n", pista);
+        investigacao->raizPistas = inserirPista(investigacao, investigacao->raizPistas, pista);
+        inserirNaHash(investigacao, buscarPista(investigacao, investigacao->raizPistas, pista), suspeito);
+    }
+}
+
+/*
+Função: processarComando
+Descrição:
+Motor da exploração: aplica um único comando à sessão, sem fazer nenhuma leitura.
+Quem chama decide de onde os comandos vêm (terminal, pipe, arquivo...).
+*/
+void processarComando(Sessao* sessao, char opcao) {
+    const Mansao* mansao = sessao->mansao;
+
+    if (opcao == 's') {
+        fprintf(sessao->saida, "\nVocê decidiu parar a exploração. Até a próxima, detetive!\n");
+        sessao->ativa = 0;
+        return;
+    }
+    else if (opcao == 'p') {
+        exibirHash(sessao->saida, sessao->investigacao);
+    }
+    else if (opcao == 'm') {
+        exibirRelatorioMemoria(sessao->saida, mansao, sessao->investigacao);
+    }
+    else if (opcao == 'e') {
+        if (mansao->salas[sessao->atual].esquerda != NULO) {
+            sessao->atual = mansao->salas[sessao->atual].esquerda;
+            registrarPistaDaSala(sessao);
+        } else {
+            fprintf(sessao->saida, "\nNão há caminho à esquerda.\n");
+        }
+    }
+    else if (opcao == 'd') {
+        if (mansao->salas[sessao->atual].direita != NULO) {
+            sessao->atual = mansao->salas[sessao->atual].direita;
+            registrarPistaDaSala(sessao);
+        } else {
+            fprintf(sessao->saida, "\nNão há caminho à direita.\n");
         }
-        else if (opcao == 'e') {
-            if (atual->esquerda != NULL) {
-                atual = atual->esquerda;
-
-                // Pistas automáticas e associações
-                if (strcmp(atual->nome, "Biblioteca Misteriosa") == 0) {
-                    printf("\nVocê encontrou uma pista: 'Diário Rasgado'\n");
-                    *arvorePistas = inserirPista(*arvorePistas, "Diário Rasgado");
-                    inserirNaHash(tabela, "Diário Rasgado", "Sr. Blackwood");
-                } else if (strcmp(atual->nome, "Jardim Abandonado") == 0) {
-                    printf("\nVocê encontrou uma pista: 'Chave Enferrujada'\n");
-                    *arvorePistas = inserirPista(*arvorePistas, "Chave Enferrujada");
-                    inserirNaHash(tabela, "Chave Enferrujada", "Sra. Violet");
-                }
-
-            } else {
-                printf("\nNão há caminho à esquerda.\n");
+    }
+    else {
+        fprintf(sessao->saida, "\nOpção inválida! Tente novamente.\n");
+    }
+
+    // Fim do caminho (nó folha)
+    if (mansao->salas[sessao->atual].esquerda == NULO && mansao->salas[sessao->atual].direita == NULO) {
+        fprintf(sessao->saida, "\nVocê chegou ao fim do caminho na sala: %s\n",
+                nomeDe(&mansao->nomes, mansao->salas[sessao->atual].nome));
+        sessao->ativa = 0;
+    }
+}
+
+/*
+Função: explorarSalas
+Descrição:
+Laço principal do jogo. A cada leitura (bloqueante) pega uma linha inteira,
+guarda os comandos dela na fila e os aplica um por um com processarComando
+antes de ler a próxima linha, ou seja, o lote é de uma linha por leitura.
+A saída da sessão fica em buffer e só é enviada (fflush) quando o jogo
+precisa esperar nova entrada.
+*/
+void explorarSalas(const Mansao* mansao, uint32_t inicio, Investigacao* investigacao, FILE* entrada, FILE* saida) {
+    Sessao sessao;
+    char opcao;
+
+    sessao.mansao = mansao;
+    sessao.investigacao = investigacao;
+    sessao.atual = inicio;
+    sessao.saida = saida;
+    sessao.fila.inicio = 0;
+    sessao.fila.quantidade = 0;
+    sessao.ativa = 1;
+
+    while (sessao.ativa) {
+        // Só mostra o menu e espera entrada quando não há comandos pendentes
+        if (sessao.fila.quantidade == 0) {
+            exibirMenu(&sessao);
+            fflush(sessao.saida);
+            if (!lerComandos(entrada, sessao.saida, &sessao.fila)) {
+                fprintf(sessao.saida, "\nEntrada encerrada. Fim da exploração.\n");
+                break;
             }
         }
-        else if (opcao == 'd') {
-            if (atual->direita != NULL) {
-                atual = atual->direita;
 
+        while (sessao.ativa && desenfileirarComando(&sessao.fila, &opcao)) {
+            processarComando(&sessao, opcao);
+        }
+    }
+    fflush(sessao.saida);
+}
+
+/*
+Função principal: main
+Descrição:
+Monta a mansão, inicia a exploração e, ao final, mostra a análise dos suspeitos.
+*/
+int main() {
+    static char bufferSaida[TAM_BUFFER_SAIDA];
+
+    // A sessão usa stdout: totalmente bufferizada, várias mensagens viram uma única escrita
+    setvbuf(stdout, bufferSaida, _IOFBF, sizeof(bufferSaida));
+
+    Mansao mansao;
+    iniciarMansao(&mansao);
+
+    // Criação das salas (mesmo mapa dos níveis anteriores)
+    uint32_t hall = criarSala(&mansao, "Hall de Entrada");
+    uint32_t biblioteca = criarSala(&mansao, "Biblioteca Misteriosa");
+    uint32_t cozinha = criarSala(&mansao, "Cozinha Antiga");
+    uint32_t jardim = criarSala(&mansao, "Jardim Abandonado");
+    uint32_t porao = criarSala(&mansao, "Porão Escuro");
+
+    // Montagem da árvore binária de salas
+    mansao.salas[hall].esquerda = biblioteca;
+    mansao.salas[hall].direita = cozinha;
+    mansao.salas[biblioteca].esquerda = jardim;
+    mansao.salas[biblioteca].direita = porao;
+
+    // Pistas e tabela hash do jogador começam vazias
+    Investigacao investigacao;
+    iniciarInvestigacao(&investigacao);
+
+    // Inicia a exploração da mansão
+    explorarSalas(&mansao, hall, &investigacao, stdin, stdout);
+
+    // Análise final: associações e suspeito mais citado
+    exibirHash(stdout, &investigacao);
+    contarSuspeitos(stdout, &investigacao);
+    fflush(stdout);
+
+    // Libera memória: um free por vetor
+    liberarInvestigacao(&investigacao);
+    liberarMansao(&mansao);
+
+    return 0;
+}